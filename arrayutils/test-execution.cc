@@ -0,0 +1,65 @@
+#include "arrayutils"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+TEST(arrayutils, execution_policy) {
+  std::vector<double> v(1 << 20), w;
+  std::iota(v.begin(), v.end(), 0.);
+  w = v;
+  yuc::reverse(yuc::execution::par, v, 512, 64);
+  yuc::reverse(w, 512, 64);
+  EXPECT_EQ(w, v);
+
+  yuc::transpose(yuc::execution::par, v, 1024);
+  yuc::transpose(w, 1024);
+  EXPECT_EQ(w, v);
+  yuc::transpose(yuc::execution::par, v, 256, 64, {4, 1, 4});
+  yuc::transpose(w, 256, 64, {4, 1, 4});
+  EXPECT_EQ(w, v);
+
+  auto sq = [](size_t i) { return i * 0.5; };
+  auto a = yuc::genspace<double>(yuc::execution::par, 1 << 18, sq);
+  auto b = yuc::genspace<double>(1 << 18, sq);
+  EXPECT_TRUE((a == b).min());
+  const std::valarray<double> head = a[std::slice(0, 64, 1)];
+  auto c = yuc::meshgrid(yuc::execution::par, 64, head, 64);
+  auto d = yuc::meshgrid(64, head, 64);
+  EXPECT_TRUE((c == d).min());
+}
+
+TEST(arrayutils, execution_executor) {
+  // an external pool: one std::thread per task
+  size_t ncall = 0;
+  yuc::execution::parallel_policy policy;
+  policy.executor = [&](size_t ntask, const auto &task) {
+    ++ncall;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ntask; ++i) {
+      threads.emplace_back(task, i);
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+  };
+  std::vector<int> v(1 << 20), w;
+  std::iota(v.begin(), v.end(), 0);
+  w = v;
+  yuc::reverse(policy, v, v.size(), 1, 1);
+  std::reverse(w.begin(), w.end());
+  EXPECT_EQ(w, v);
+  EXPECT_EQ(1u, ncall);
+
+  // small work stays on the calling thread
+  yuc::reverse(policy, v, 16, 1, 1);
+  EXPECT_EQ(1u, ncall);
+
+  EXPECT_THROW(yuc::genspace<double>(yuc::execution::par, 1 << 20,
+                                     [](size_t i) -> double {
+                                       if (i == 12345) {
+                                         throw std::range_error("bad");
+                                       }
+                                       return i;
+                                     }),
+               std::range_error);
+}
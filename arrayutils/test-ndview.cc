@@ -0,0 +1,63 @@
+#include "arrayutils"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+TEST(arrayutils, ndview_zero_copy) {
+  std::vector<double> v(2 * 3 * 4);
+  std::iota(v.begin(), v.end(), 0.);
+  yuc::ndview<double, 3> a(v, {2, 3, 4});
+  EXPECT_TRUE(a.is_contiguous());
+  EXPECT_EQ(23., a(1, 2, 3));
+
+  auto r = a.reversed(1);
+  EXPECT_EQ(a(1, 2, 3), r(1, 0, 3));
+  EXPECT_EQ(v.data(), a.data());
+  auto t = a.transposed();
+  EXPECT_EQ((std::array<size_t, 3>{2, 4, 3}), t.shape());
+  EXPECT_EQ(a(1, 2, 3), t(1, 3, 2));
+  auto p = a.permuted({2, 0, 1});
+  EXPECT_EQ(a(1, 2, 3), p(3, 1, 2));
+  EXPECT_FALSE(p.is_contiguous());
+  EXPECT_THROW(a.permuted({0, 0, 1}), std::logic_error);
+
+  r(0, 0, 0) = -1;
+  EXPECT_EQ(-1, v[8]);
+  yuc::ndview<const double, 3> c = r;
+  EXPECT_EQ(-1, c(0, 0, 0));
+
+  auto flat = a.reshaped<2>({6, 4});
+  EXPECT_EQ(a(1, 2, 3), flat(5, 3));
+  EXPECT_THROW(t.reshaped<2>({6, 4}), std::logic_error);
+  EXPECT_THROW(a.reshaped<2>({5, 4}), std::logic_error);
+  EXPECT_THROW((yuc::ndview<double, 2>(v, {5, 4})), std::logic_error);
+}
+
+TEST(arrayutils, ndview_contiguous) {
+  // matches the in-place kernels
+  std::valarray<double> v(7 * 300 * 2 * 130 * 3);
+  std::iota(std::begin(v), std::end(v), 0.);
+  yuc::ndview<double, 5> a(v, {7, 300, 2, 130, 3});
+  auto t = v;
+  yuc::transpose(t, 300, 130, {7, 2, 3});
+  EXPECT_TRUE((t == a.transposed(1, 3).contiguous()).min());
+  EXPECT_TRUE(
+      (t == a.transposed(1, 3).contiguous(yuc::execution::par)).min());
+  auto r = v;
+  yuc::reverse(r, 2, 7 * 300, 130 * 3);
+  EXPECT_TRUE((r == a.reversed(2).contiguous()).min());
+
+  // arbitrary permutation with a reversed axis, checked element-wise
+  auto p = a.permuted({3, 0, 4, 2, 1}).reversed(4);
+  const auto pc = p.contiguous();
+  size_t i = 0;
+  for (size_t i0 = 0; i0 < p.shape(0); ++i0)
+    for (size_t i1 = 0; i1 < p.shape(1); ++i1)
+      for (size_t i2 = 0; i2 < p.shape(2); ++i2)
+        for (size_t i3 = 0; i3 < p.shape(3); ++i3)
+          for (size_t i4 = 0; i4 < p.shape(4); ++i4, ++i)
+            ASSERT_EQ(p(i0, i1, i2, i3, i4), pc[i]);
+  auto round = p.contiguous();
+  yuc::ndview<double, 5>(round, p.shape()).copy_to(std::begin(round));
+  EXPECT_TRUE((pc == round).min());
+}
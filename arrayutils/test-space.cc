@@ -0,0 +1,55 @@
+#include "arrayutils"
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(arrayutils, space_view) {
+  auto lin = yuc::linspace_view(1, 2, 0.25);
+  ASSERT_EQ(5u, lin.size());
+  EXPECT_DOUBLE_EQ(1.5, lin[2]);
+  EXPECT_DOUBLE_EQ(2, *(lin.end() - 1));
+  EXPECT_EQ(3, std::lower_bound(lin.begin(), lin.end(), 1.6) - lin.begin());
+  const auto a = yuc::linspace(1, 2, 0.25), b = lin.materialize();
+  EXPECT_TRUE((a == b).min());
+
+  auto log = yuc::logspace_view(1, 1000, 10);
+  ASSERT_EQ(4u, log.size());
+  double expect = 1;
+  for (double x : log) {
+    EXPECT_NEAR(expect, x, 1e-12 * expect);
+    expect *= 10;
+  }
+  const auto c = yuc::logspace(1, 1000, 10);
+  EXPECT_TRUE((c == log.materialize(yuc::execution::par)).min());
+
+  auto sq = yuc::genspace_view<int>(4, [](size_t i) { return i * i; });
+  EXPECT_EQ(9, sq[3]);
+  EXPECT_EQ(4, sq.end() - sq.begin());
+}
+
+TEST(arrayutils, meshgrid_view) {
+  const std::valarray<double> arr = {1, 2, 3};
+  auto mg = yuc::meshgrid_view(2, arr, 4);
+  ASSERT_EQ(24u, mg.size());
+  for (size_t il = 0, i = 0; il < 2; ++il) {
+    for (size_t ia = 0; ia < 3; ++ia) {
+      for (size_t ir = 0; ir < 4; ++ir, ++i) {
+        EXPECT_EQ(arr[ia], mg[i]) << i;
+      }
+    }
+  }
+  EXPECT_TRUE((yuc::meshgrid(2, arr, 4) == mg.materialize()).min());
+
+  // mixed with materialized columns in a zipped loop
+  const std::vector<double> w(mg.size(), 0.5);
+  double sum = 0;
+  size_t n = 0;
+  for (auto &&[x, wx, i] :
+       yuc::thread(mg, w, yuc::genspace_view<size_t>(mg.size(), [](size_t i) {
+                     return i;
+                   }))) {
+    sum += x * wx;
+    EXPECT_EQ(n++, i);
+  }
+  EXPECT_EQ(24u, n);
+  EXPECT_DOUBLE_EQ(24, sum);
+}
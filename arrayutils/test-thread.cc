@@ -0,0 +1,104 @@
+#include "arrayutils"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST(arrayutils, thread_random_access) {
+  std::vector<int> a = {0, 1, 2, 3, 4, 5, 6};
+  std::valarray<double> b = {0, 10, 20, 30, 40, 50, 60};
+  auto zip = yuc::thread(a, b);
+  using iterator = decltype(zip.begin());
+  static_assert(std::is_same_v<std::random_access_iterator_tag,
+                               iterator::iterator_category>);
+  EXPECT_EQ(7u, zip.size());
+
+  auto it = zip.begin() + 3;
+  EXPECT_EQ(3, std::get<0>(*it));
+  EXPECT_EQ(50, std::get<1>(it[2]));
+  EXPECT_EQ(3, it - zip.begin());
+  std::get<1>(*--it) = -1;
+  EXPECT_EQ(-1, b[2]);
+
+  size_t total = 0;
+  for (const auto &chunk : zip.partition(3)) {
+    EXPECT_GE(chunk.size(), 2u);
+    for (auto &&[x, y] : chunk) {
+      EXPECT_EQ(a[total], x);
+      EXPECT_EQ(b[total], y);
+      ++total;
+    }
+  }
+  EXPECT_EQ(a.size(), total);
+  EXPECT_EQ(1u, zip.partition(0).size());
+  EXPECT_EQ(7u, zip.partition(100).size());
+
+  // begin and end of the same type, usable by the standard algorithms
+  static_assert(std::is_same_v<iterator, decltype(zip.end())>);
+  EXPECT_EQ(7, std::distance(zip.begin(), zip.end()));
+  auto last = zip.end();
+  EXPECT_EQ(60, std::get<1>(*--last));
+  EXPECT_EQ(6, std::get<0>(*last--));
+  EXPECT_TRUE(zip.begin() < last && last > zip.begin());
+  EXPECT_TRUE(last <= last && last >= last && !(last > last));
+  EXPECT_EQ(last, 5 + zip.begin());
+}
+
+TEST(arrayutils, thread_sort) {
+  std::vector<int> key = {3, 1, 4, 1, 5, 9, 2, 6};
+  std::vector<std::string> name = {"c", "a", "d", "b", "e", "i", "f", "g"};
+  auto zip = yuc::thread(key, name);
+  std::sort(zip.begin(), zip.end(), [](const auto &l, const auto &r) {
+    return std::get<0>(l) < std::get<0>(r);
+  });
+  EXPECT_EQ(std::vector<int>({1, 1, 2, 3, 4, 5, 6, 9}), key);
+  EXPECT_EQ("f", name[2]);
+  EXPECT_EQ("i", name[7]);
+  EXPECT_TRUE(name[0] == "a" || name[0] == "b");
+  std::reverse(zip.begin(), zip.end());
+  EXPECT_EQ(9, key[0]);
+  EXPECT_EQ("i", name[0]);
+}
+
+TEST(arrayutils, parallel_for_each) {
+  const size_t n = 1 << 18;
+  std::vector<double> x(n), y(n), z(n);
+  std::iota(x.begin(), x.end(), 0.);
+  std::iota(y.begin(), y.end(), 1.);
+
+  yuc::parallel_for_each(yuc::execution::par, yuc::thread(x, y, z),
+                         [](auto &&e) {
+                           auto &&[xi, yi, zi] = e;
+                           zi = xi * yi;
+                         });
+  for (size_t i = 0; i < n; i += 997) {
+    EXPECT_EQ(x[i] * y[i], z[i]);
+  }
+  yuc::parallel_for_each(yuc::thread(x, y, z), [](auto &&e) {
+    auto &&[xi, yi, zi] = e;
+    zi = xi + yi;
+  });
+  for (size_t i = 0; i < n; i += 997) {
+    EXPECT_EQ(x[i] + y[i], z[i]);
+  }
+
+  // an external pool running every chunk on its own thread
+  yuc::execution::parallel_policy policy;
+  policy.executor = [](size_t ntask, const auto &task) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ntask; ++i) {
+      threads.emplace_back(task, i);
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+  };
+  auto ids = yuc::genspace_view<size_t>(n, [](size_t i) { return i; });
+  yuc::parallel_for_each(policy, yuc::thread(ids, z), [](auto &&e) {
+    auto &&[i, zi] = e;
+    zi = i;
+  });
+  for (size_t i = 0; i < n; i += 997) {
+    EXPECT_EQ(i, z[i]);
+  }
+}
@@ -0,0 +1,98 @@
+#include "arrayutils"
+#include <chrono>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+// out-of-place reference of [n0][na][n1][nb][n2] => [n0][nb][n1][na][n2]
+static std::vector<double> transposed(const std::vector<double> &v, size_t na,
+                                      size_t nb,
+                                      const std::array<size_t, 3> &ns) {
+  std::vector<double> t(v.size());
+  for (size_t i0 = 0; i0 < ns[0]; ++i0)
+    for (size_t ia = 0; ia < na; ++ia)
+      for (size_t i1 = 0; i1 < ns[1]; ++i1)
+        for (size_t ib = 0; ib < nb; ++ib)
+          for (size_t i2 = 0; i2 < ns[2]; ++i2)
+            t[((((i0 * nb + ib) * ns[1] + i1) * na + ia) * ns[2]) + i2] =
+                v[((((i0 * na + ia) * ns[1] + i1) * nb + ib) * ns[2]) + i2];
+  return t;
+}
+
+TEST(arrayutils, transpose) {
+  const std::vector<std::array<size_t, 5>> shapes = {
+      {1, 1, 1, 1, 1},   {1, 300, 1, 300, 1}, {2, 70, 3, 70, 2},
+      {1, 3, 1, 5, 1},   {1, 128, 1, 96, 1},  {3, 17, 2, 31, 3},
+      {2, 1, 4, 9, 1},   {1, 640, 1, 2, 1},   {1, 12, 1, 18, 1},
+      {2, 4, 2, 2, 1},   {1, 6, 3, 2, 2},     {1, 3, 1, 40000, 1},
+  };
+  for (const auto &s : shapes) {
+    const size_t na = s[1], nb = s[3];
+    const std::array<size_t, 3> ns = {s[0], s[2], s[4]};
+    std::vector<double> v(s[0] * s[1] * s[2] * s[3] * s[4]);
+    for (size_t i = 0; i < v.size(); ++i) {
+      v[i] = i;
+    }
+    const auto ref = transposed(v, na, nb, ns);
+    yuc::transpose(v, na, nb, ns);
+    EXPECT_EQ(ref, v) << na << "x" << nb;
+    yuc::transpose(v, nb, na, ns);
+    EXPECT_EQ(transposed(ref, nb, na, ns), v);
+  }
+
+  // every row and column block on its own thread
+  yuc::execution::parallel_policy policy;
+  policy.executor = [](size_t ntask, const auto &task) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ntask; ++i) {
+      threads.emplace_back(task, i);
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+  };
+  std::vector<double> v(1000 * 1500);
+  for (size_t i = 0; i < v.size(); ++i) {
+    v[i] = i;
+  }
+  const auto ref = transposed(v, 1000, 1500, {1, 1, 1});
+  yuc::transpose(policy, v, 1000, 1500);
+  EXPECT_EQ(ref, v);
+  yuc::transpose(policy, v, 1500, 1000);
+  EXPECT_EQ(transposed(ref, 1500, 1000, {1, 1, 1}), v);
+
+  std::valarray<double> va = {0, 1, 2, 3, 4, 5};
+  yuc::transpose(va, 2, 3);
+  EXPECT_EQ(3., va[1]);
+  EXPECT_EQ(1., va[2]);
+}
+
+// Run with --gtest_also_run_disabled_tests; the matrix size is taken from
+// YUC_BENCH_TRANSPOSE_N (e.g. 16384 for 16k x 16k, needing 2 GiB).
+TEST(arrayutils, DISABLED_bench_transpose) {
+  const char *env = std::getenv("YUC_BENCH_TRANSPOSE_N");
+  const size_t n = env ? std::atol(env) : 4096;
+  std::vector<double> v(n * n), w(n * n);
+  for (size_t i = 0; i < v.size(); ++i) {
+    v[i] = i;
+  }
+  const double gb = 2. * v.size() * sizeof(double) / 1e9; // read + write
+  auto rate = [&](auto &&fn) {
+    const auto t0 = std::chrono::steady_clock::now();
+    fn();
+    const std::chrono::duration<double> dt =
+        std::chrono::steady_clock::now() - t0;
+    return gb / dt.count();
+  };
+  const double copy = rate([&] { std::copy(v.begin(), v.end(), w.begin()); });
+  const double square = rate([&] { yuc::transpose(v, n); });
+  const double rect = rate([&] { yuc::transpose(v, n, n / 2, {1, 1, 2}); });
+  const double skinny = rate([&] { yuc::transpose(v, n / 8, 8 * n); });
+  yuc::transpose(v, 8 * n, n / 8);
+  std::cout << "transpose " << n << "x" << n << " doubles [GB/s]:"
+            << " memcpy " << copy << ", square " << square
+            << ", rectangular " << rect << ", " << n / 8 << "x" << 8 * n
+            << " " << skinny << std::endl;
+  EXPECT_EQ(double(n), v[1]);
+}
@@ -0,0 +1,524 @@
+#include "histogram"
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+
+static void check_locate(const yuc::histogram &h, double x) {
+  const auto &ed = h.x_edges();
+  const size_t ref = std::upper_bound(std::begin(ed), std::end(ed), x) -
+                     std::begin(ed);
+  const size_t loc = h.locate(x);
+  EXPECT_EQ(ref < ed.size() ? ref - 1 : size_t(-1), loc) << x;
+}
+
+TEST(histogram, locate_grid) {
+  yuc::histogram hlin, hlog;
+  hlin.rebin(-3.7, 11.3, 997);
+  hlog.rebin(1e-6, 1e6, -10000);
+  EXPECT_EQ(yuc::histogram::grid_kind::linear, hlin.grid());
+  EXPECT_EQ(yuc::histogram::grid_kind::logarithmic, hlog.grid());
+
+  std::mt19937_64 rng(42);
+  for (const auto *h : {&hlin, &hlog}) {
+    const auto &ed = h->x_edges();
+    for (size_t i = 0; i < ed.size(); ++i) {
+      check_locate(*h, ed[i]);
+      check_locate(*h, std::nextafter(ed[i], -HUGE_VAL));
+      check_locate(*h, std::nextafter(ed[i], HUGE_VAL));
+    }
+    std::uniform_real_distribution<double> u(ed[0] * 1.1 - 1,
+                                             ed[ed.size() - 1] * 1.1 + 1);
+    for (size_t i = 0; i < 100000; ++i) {
+      check_locate(*h, u(rng));
+    }
+    for (double x : {-HUGE_VAL, HUGE_VAL, 0., -1., double(NAN)}) {
+      check_locate(*h, x);
+    }
+  }
+}
+
+TEST(histogram, fill_grid) {
+  yuc::histogram hgrid, harb;
+  hgrid.rebin(1., 100., -50);
+  harb.rebin(hgrid.x_edges());
+  EXPECT_EQ(yuc::histogram::grid_kind::arbitrary, harb.grid());
+
+  std::mt19937_64 rng(7);
+  std::uniform_real_distribution<double> u(0, 120);
+  for (size_t i = 0; i < 10000; ++i) {
+    const double x = u(rng);
+    hgrid.fill(x), harb.fill(x);
+  }
+  for (size_t i = 0; i < hgrid.size(); ++i) {
+    EXPECT_EQ(harb.weight(i), hgrid.weight(i));
+  }
+  EXPECT_EQ(harb.mean(), hgrid.mean());
+}
+
+TEST(histogram, fill_batch) {
+  std::mt19937_64 rng(11);
+  std::uniform_real_distribution<double> u(-1, 130), uw(0, 2);
+  std::valarray<double> xs(1000), ws(1000);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    xs[i] = u(rng), ws[i] = uw(rng);
+  }
+
+  for (int nbin : {40, -40}) {
+    yuc::histogram hs, hb;
+    hs.rebin(0.5, 128, nbin);
+    hb.rebin(0.5, 128, nbin);
+    for (size_t i = 0; i < xs.size(); ++i) {
+      hs.fill(xs[i], ws[i]);
+    }
+    hb.fill(xs, ws);
+    for (size_t i = 0; i < hs.size(); ++i) {
+      EXPECT_DOUBLE_EQ(hs.weight(i), hb.weight(i));
+    }
+    // total weight is summed blockwise in the batch version
+    EXPECT_NEAR(hs.total_weight(), hb.total_weight(), 1e-12 * xs.size());
+    EXPECT_NEAR(hs.mean(), hb.mean(), 1e-12 * hs.mean());
+    EXPECT_NEAR(hs.variance(), hb.variance(), 1e-12 * hs.variance());
+  }
+}
+
+TEST(multihist, fill_batch) {
+  std::mt19937_64 rng(13);
+  std::uniform_real_distribution<double> u(-1, 11);
+  std::array<std::valarray<double>, 2> xs{std::valarray<double>(700),
+                                          std::valarray<double>(700)};
+  for (size_t i = 0; i < xs[0].size(); ++i) {
+    xs[0][i] = u(rng), xs[1][i] = u(rng);
+  }
+
+  yuc::multihist<2> hs, hb;
+  for (auto *h : {&hs, &hb}) {
+    h->rebin("x", {0., 1., 2.5, 5., 10.});
+    h->rebin("y", {0., 3., 6., 9.});
+  }
+  for (size_t i = 0; i < xs[0].size(); ++i) {
+    hs.fill({xs[0][i], xs[1][i]});
+  }
+  hb.fill(xs);
+  EXPECT_EQ(hs.total_weight(), hb.total_weight());
+  ASSERT_EQ(hs.weight().size(), hb.weight().size());
+  for (size_t i = 0; i < hs.weight().size(); ++i) {
+    EXPECT_EQ(hs.weight()[i], hb.weight()[i]) << i;
+  }
+}
+
+TEST(histogram, merge) {
+  yuc::histogram h1, h2, h3;
+  h1.rebin(0, 10, 10);
+  h2.rebin(0, 10, 10);
+  h3.rebin(0, 10, 5);
+  h1.fill(1.5), h1.fill(2.5, 2.);
+  h2.fill(1.5, 3.);
+  h1 += h2;
+  EXPECT_EQ(4., h1.weight(1));
+  EXPECT_EQ(2., h1.weight(2));
+  EXPECT_EQ(6., h1.total_weight());
+  EXPECT_THROW(h1.merge(h3), std::logic_error);
+}
+
+TEST(histogram, concurrent_fill) {
+  yuc::histogram proto;
+  proto.rebin(1e-3, 1e3, -60);
+  yuc::concurrent_histogram ch(proto);
+
+  std::vector<std::thread> pool;
+  for (size_t it = 0; it < 4; ++it) {
+    pool.emplace_back([&ch, it] {
+      for (size_t i = 0; i < 10000; ++i) {
+        ch.fill(std::pow(10., (i % 600) / 100. - 3), double(it + 1));
+      }
+    });
+  }
+  for (auto &t : pool) {
+    t.join();
+  }
+  EXPECT_EQ(4, ch.shards());
+
+  yuc::histogram ref = proto;
+  for (size_t it = 0; it < 4; ++it) {
+    for (size_t i = 0; i < 10000; ++i) {
+      ref.fill(std::pow(10., (i % 600) / 100. - 3), double(it + 1));
+    }
+  }
+  const auto h = ch.reduce();
+  EXPECT_EQ(ref.total_weight(), h.total_weight());
+  for (size_t i = 0; i < h.size(); ++i) {
+    EXPECT_EQ(ref.weight(i), h.weight(i));
+  }
+
+  // threads alternating between more histograms than they remember
+  std::vector<std::unique_ptr<yuc::concurrent_histogram>> chs;
+  for (size_t k = 0; k < 10; ++k) {
+    chs.push_back(std::make_unique<yuc::concurrent_histogram>(proto));
+  }
+  pool.clear();
+  for (size_t it = 0; it < 4; ++it) {
+    pool.emplace_back([&chs] {
+      for (size_t i = 0; i < 10000; ++i) {
+        chs[i % (i < 5000 ? 2 : chs.size())]->fill(1., 1.);
+      }
+    });
+  }
+  for (auto &t : pool) {
+    t.join();
+  }
+  EXPECT_EQ(4 * (2500. + 500.), chs[0]->reduce().total_weight());
+  EXPECT_EQ(4 * 500., chs[9]->reduce().total_weight());
+  for (const auto &c : chs) {
+    EXPECT_EQ(4, c->shards());
+  }
+}
+
+TEST(histogram, rebin) {
+  std::mt19937_64 rng(17);
+  std::uniform_real_distribution<double> u(-1, 11);
+  yuc::histogram hfine, hcoarse;
+  hfine.rebin(0, 10, 20);
+  hcoarse.rebin(0, 10, 5);
+  for (size_t i = 0; i < 1000; ++i) {
+    const double x = u(rng);
+    hfine.fill(x), hcoarse.fill(x);
+  }
+  const double mean = hfine.mean(), var = hfine.variance();
+
+  hfine.rebin(0, 10, 5); // subset of the old edges: exact merge
+  EXPECT_EQ(yuc::histogram::grid_kind::linear, hfine.grid());
+  ASSERT_EQ(hcoarse.size(), hfine.size());
+  for (size_t i = 0; i < hfine.size(); ++i) {
+    EXPECT_EQ(hcoarse.weight(i), hfine.weight(i));
+  }
+  EXPECT_DOUBLE_EQ(mean, hfine.mean());
+  EXPECT_DOUBLE_EQ(var, hfine.variance());
+
+  yuc::histogram h;
+  h.rebin({0., 2., 4.});
+  h.fill(size_t(0), 4.), h.fill(size_t(1), 2.);
+  h.rebin({-1., 1., 3., 5.}); // proportional split
+  EXPECT_DOUBLE_EQ(2., h.weight(0));
+  EXPECT_DOUBLE_EQ(3., h.weight(1));
+  EXPECT_DOUBLE_EQ(1., h.weight(2));
+  EXPECT_DOUBLE_EQ(6., h.weight().sum());
+
+  // split bins take the moments of a uniform distribution over each piece
+  yuc::histogram hm;
+  hm.rebin({0., 2., 4.});
+  hm.fill(0.2, 4.), hm.fill(2.2, 2.);
+  hm.rebin({-1., 1., 3., 5.});
+  EXPECT_DOUBLE_EQ((2 * 0.5 + 2 * 1.5 + 2.5 + 3.5) / 6, hm.mean());
+  hm.rebin({-1., 3., 5.}); // merge only: exact
+  EXPECT_DOUBLE_EQ((2 * 0.5 + 2 * 1.5 + 2.5 + 3.5) / 6, hm.mean());
+}
+
+TEST(multihist, rebin) {
+  std::mt19937_64 rng(19);
+  std::uniform_real_distribution<double> u(-1, 11);
+  yuc::multihist<3> hfine, hcoarse;
+  hfine.rebin("x", {0., 2., 4., 6., 8., 10.});
+  hfine.rebin("y", {0., 1., 2., 3., 4., 5., 6.});
+  hfine.rebin("z", {0., 5., 10.});
+  hcoarse.rebin("x", {0., 2., 4., 6., 8., 10.});
+  hcoarse.rebin("y", {0., 3., 6.});
+  hcoarse.rebin("z", {0., 5., 10.});
+  for (size_t i = 0; i < 1000; ++i) {
+    const std::valarray<double> v = {u(rng), u(rng), u(rng)};
+    hfine.fill(v), hcoarse.fill(v);
+  }
+  hfine.rebin("y", {0., 3., 6.});
+  ASSERT_EQ(hcoarse.weight().size(), hfine.weight().size());
+  for (size_t i = 0; i < hfine.weight().size(); ++i) {
+    EXPECT_EQ(hcoarse.weight()[i], hfine.weight()[i]) << i;
+  }
+}
+
+TEST(histogram, quantile) {
+  yuc::histogram h;
+  h.rebin(0, 10, 10);
+  for (size_t i = 0; i < 10; ++i) {
+    h.fill(i + 0.5, 1.);
+  }
+  EXPECT_DOUBLE_EQ(5., h.quantile(0.5));
+  EXPECT_DOUBLE_EQ(9.9, h.quantile(0.99));
+  EXPECT_DOUBLE_EQ(0., h.quantile(0.));
+  EXPECT_DOUBLE_EQ(10., h.quantile(1.));
+  EXPECT_TRUE(std::isnan(h.quantile(1.5)));
+  EXPECT_DOUBLE_EQ(0.25, h.interp_cdf(2.5));
+  EXPECT_DOUBLE_EQ(0., h.interp_cdf(-1.));
+  EXPECT_DOUBLE_EQ(1., h.interp_cdf(10.));
+  EXPECT_DOUBLE_EQ(0.1, h.interp_pdf(3.3));
+  EXPECT_DOUBLE_EQ(0., h.interp_pdf(11.));
+
+  h.fill(9.5, 10.); // invalidates the cached cdf
+  EXPECT_DOUBLE_EQ(9. + 1. / 11., h.quantile(0.5));
+  EXPECT_DOUBLE_EQ(0.45, h.cdf()[8]);
+
+  const std::valarray<double> ps = {0.05, 0.5, 0.95};
+  const auto qs = h.quantile(ps);
+  ASSERT_EQ(ps.size(), qs.size());
+  for (size_t i = 0; i < qs.size(); ++i) {
+    EXPECT_DOUBLE_EQ(h.quantile(ps[i]), qs[i]);
+    EXPECT_NEAR(ps[i], h.interp_cdf(qs[i]), 1e-12);
+  }
+
+  // const queries from several threads on a stale cache
+  h.fill(0.5);
+  const yuc::histogram &ch = h;
+  std::vector<double> medians(4);
+  std::vector<std::thread> readers;
+  for (size_t t = 0; t < medians.size(); ++t) {
+    readers.emplace_back([&, t] { medians[t] = ch.quantile(0.5); });
+  }
+  for (auto &r : readers) {
+    r.join();
+  }
+  for (const double m : medians) {
+    EXPECT_EQ(h.quantile(0.5), m);
+  }
+}
+
+TEST(sparse_histogram, linear) {
+  std::mt19937_64 rng(23);
+  std::normal_distribution<double> g(-3, 20);
+  yuc::sparse_histogram hs(0.25, 0.5);
+  yuc::histogram hd;
+  std::valarray<double> edges(1201);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    edges[i] = hs.x_edges(long(i) - 600);
+  }
+  hd.rebin(edges);
+  for (size_t i = 0; i < 10000; ++i) {
+    const double x = g(rng);
+    hs.fill(x), hd.fill(x);
+  }
+  hs.fill(NAN, 3.);
+  EXPECT_EQ(3., hs.dropped_weight());
+  EXPECT_EQ(hd.total_weight(), hs.total_weight());
+  EXPECT_NEAR(hd.mean(), hs.mean(), 1e-9);
+  EXPECT_NEAR(hd.variance(), hs.variance(), 1e-6);
+  for (size_t i = 0; i < hd.size(); ++i) {
+    const long k = long(i) - 600;
+    EXPECT_EQ(hd.weight(i), hs.weight(k)) << k;
+  }
+  EXPECT_NEAR(hd.cdf()[610], hs.cdf(10), 1e-12);
+
+  const auto h = hs.to_histogram();
+  EXPECT_EQ(size_t(hs.kmax() - hs.kmin() + 1), h.size());
+  EXPECT_EQ(hs.total_weight(), h.total_weight());
+  EXPECT_NEAR(hs.mean(), h.mean(), 1e-9);
+  for (const long k : hs.occupied()) {
+    EXPECT_EQ(hs.weight(k), h.weight(k - hs.kmin()));
+  }
+}
+
+TEST(sparse_histogram, logarithmic) {
+  yuc::sparse_histogram hs(1., std::pow(10., 1e-3),
+                           yuc::histogram::grid_kind::logarithmic);
+  for (int e = -6; e <= 6; ++e) {
+    hs.fill(std::pow(10., e) * 1.0001);
+  }
+  hs.fill(-1.);
+  EXPECT_EQ(13., hs.total_weight());
+  EXPECT_EQ(1., hs.dropped_weight());
+  EXPECT_EQ(13, hs.pages());
+  EXPECT_EQ(13, hs.occupied().size());
+  for (const long k : hs.occupied()) {
+    EXPECT_LE(hs.x_edges(k), hs.x_lin(k));
+    EXPECT_EQ(1., hs.weight(k));
+    EXPECT_EQ(k, hs.locate(hs.x_log(k)));
+  }
+}
+
+TEST(multihist, sparse_marginalize) {
+  std::mt19937_64 rng(29);
+  std::uniform_real_distribution<double> u(-1, 11);
+  yuc::multihist<3> hd;
+  yuc::multihist<3, yuc::sparse_storage> hs;
+  yuc::multihist<1> hz;
+  yuc::multihist<2> hxz;
+  hd.rebin("x", {0., 2., 4., 6., 8., 10.});
+  hd.rebin("y", {0., 1., 2., 3., 4., 5., 6.});
+  hxz.rebin("x", {0., 2., 4., 6., 8., 10.});
+  hs.rebin("x", {0., 2., 4., 6., 8., 10.});
+  hs.rebin("y", {0., 1., 2., 3., 4., 5., 6.});
+  hs.rebin("z", {0., 5., 10.});
+  hd.rebin("z", {0., 5., 10.});
+  hxz.rebin("z", {0., 5., 10.});
+  hz.rebin("z", {0., 5., 10.});
+  for (size_t i = 0; i < 300; ++i) {
+    const double x = u(rng), y = u(rng), z = u(rng);
+    hd.fill({x, y, z}), hs.fill({x, y, z});
+    hxz.fill({x, z}), hz.fill({z});
+  }
+  ASSERT_EQ(hd.weight().size(), hs.weight().size());
+  EXPECT_LT(hs.weight().occupied(), hs.weight().size());
+  for (size_t i = 0; i < hd.weight().size(); ++i) {
+    EXPECT_EQ(hd.weight()[i], hs.weight()[i]) << i;
+  }
+
+  const auto hd_xz = hd.marginalize("y");
+  const auto hs_xz = hs.marginalize(1);
+  ASSERT_EQ(hxz.weight().size(), hd_xz.weight().size());
+  ASSERT_EQ(hxz.weight().size(), hs_xz.weight().size());
+  for (size_t i = 0; i < hxz.weight().size(); ++i) {
+    EXPECT_EQ(hxz.weight()[i], hd_xz.weight()[i]) << i;
+    EXPECT_EQ(hxz.weight()[i], hs_xz.weight()[i]) << i;
+  }
+
+  const auto hd_z = hd.marginalize(std::array<size_t, 2>{1, 0});
+  const auto hs_z = hs.marginalize(std::array<size_t, 2>{0, 1});
+  EXPECT_EQ(hz.total_weight(), hd_z.total_weight());
+  for (size_t i = 0; i < hz.weight().size(); ++i) {
+    EXPECT_EQ(hz.weight()[i], hd_z.weight()[i]) << i;
+    EXPECT_EQ(hz.weight()[i], hs_z.weight()[i]) << i;
+  }
+
+  const auto hzx = hd.project(std::array<size_t, 2>{2, 0});
+  for (size_t iz = 0; iz < 4; ++iz) {
+    for (size_t ix = 0; ix < 7; ++ix) {
+      EXPECT_EQ(hxz.weight()[ix * 4 + iz], hzx.weight()[iz * 7 + ix]);
+    }
+  }
+  EXPECT_THROW(hd.marginalize(std::array<size_t, 2>{1, 1}), std::logic_error);
+}
+
+TEST(multihist, fill_grid) {
+  std::mt19937_64 rng(31);
+  std::uniform_real_distribution<double> u(-1, 101);
+  yuc::multihist<3> hgrid, harb;
+  hgrid.rebin("x", 0., 100., 37);
+  hgrid.rebin("y", 1., 100., -23);
+  hgrid.rebin("z", 0., 50., 5);
+  harb.rebin("x", yuc::__detail::grid_edges(0., 100., 37));
+  harb.rebin("y", yuc::__detail::grid_edges(1., 100., -23));
+  harb.rebin("z", yuc::__detail::grid_edges(0., 50., 5));
+  for (size_t i = 0; i < 3000; ++i) {
+    const double x = u(rng), y = u(rng), z = u(rng);
+    harb.fill(std::valarray<double>{x, y, z});
+    switch (i % 3) {
+    case 0:
+      hgrid.fill(x, y, z);
+      break;
+    case 1:
+      hgrid.fill({x, y, z});
+      break;
+    default:
+      hgrid.fill(std::array<double, 3>{x, y, z});
+    }
+  }
+  ASSERT_EQ(harb.weight().size(), hgrid.weight().size());
+  for (size_t i = 0; i < harb.weight().size(); ++i) {
+    EXPECT_EQ(harb.weight()[i], hgrid.weight()[i]) << i;
+  }
+}
+
+TEST(multihist, fill_weighted) {
+  yuc::multihist<1> h1;
+  h1.rebin(0, {0., 1., 2.});
+  h1.fill(0.5, 3.), h1.fill(1.5), h1.fill_w(2., 1.5);
+  EXPECT_EQ(3., h1.weight()[1]);
+  EXPECT_EQ(3., h1.weight()[2]);
+  EXPECT_EQ(6., h1.total_weight());
+
+  yuc::multihist<2> h2;
+  h2.rebin(0, {0., 1., 2.}), h2.rebin(1, {0., 1., 2.});
+  h2.fill(0.5, 1.5, 4.), h2.fill_w(2., 0.5, 1.5), h2.fill(0.5, 1.5);
+  EXPECT_EQ(7., h2.weight()[1 * 4 + 2]);
+  EXPECT_EQ(7., h2.total_weight());
+}
+
+TEST(histogram, snapshot) {
+  const std::string filename = "test-histogram.hdat";
+  std::mt19937_64 rng(37);
+  std::uniform_real_distribution<double> u(0, 12);
+  yuc::histogram h;
+  h.rebin(1., 10., -17);
+  for (size_t i = 0; i < 1000; ++i) {
+    h.fill(u(rng));
+  }
+  h.save(filename);
+
+  const auto v = yuc::histogram::map(filename);
+  yuc::histogram hl;
+  hl.load(filename);
+  EXPECT_EQ(yuc::histogram::grid_kind::logarithmic, hl.grid());
+  ASSERT_EQ(h.size(), v.size());
+  ASSERT_EQ(h.size(), hl.size());
+  EXPECT_EQ(h.total_weight(), v.total_weight());
+  EXPECT_EQ(h.mean(), v.mean());
+  EXPECT_EQ(h.variance(), hl.variance());
+  for (size_t i = 0; i < h.size(); ++i) {
+    EXPECT_EQ(h.x_edges(i), v.x_edges(i));
+    EXPECT_EQ(h.weight(i), v.weight(i));
+    EXPECT_EQ(h.pdf(i), v.pdf(i));
+    EXPECT_EQ(h.weight(i), hl.weight(i));
+    EXPECT_EQ(i, v.locate(h.x_lin(i)));
+  }
+  EXPECT_EQ(h.quantile(0.9), hl.quantile(0.9));
+  EXPECT_THROW(yuc::multihist<2>::map(filename), std::runtime_error);
+  EXPECT_THROW(yuc::histogram::map("non-existing.hdat"), std::runtime_error);
+}
+
+TEST(multihist, snapshot) {
+  const std::string filename = "test-multihist.hdat";
+  std::mt19937_64 rng(41);
+  std::uniform_real_distribution<double> u(-1, 11);
+  yuc::multihist<3> hd;
+  yuc::multihist<3, yuc::sparse_storage> hs;
+  hd.rebin("x", 0., 10., 5), hs.rebin("x", 0., 10., 5);
+  hd.rebin("y", 1., 10., -6), hs.rebin("y", 1., 10., -6);
+  hd.rebin("z", {0., 5., 10.}), hs.rebin("z", {0., 5., 10.});
+  for (size_t i = 0; i < 200; ++i) {
+    const double x = u(rng), y = u(rng), z = u(rng);
+    hd.fill(x, y, z), hs.fill(x, y, z);
+  }
+
+  hd.save(filename);
+  const auto md = yuc::multihist<3>::map(filename);
+  hs.save(filename + "s");
+  const auto ms = yuc::multihist<3>::map(filename + "s");
+  yuc::multihist<3, yuc::sparse_storage> ls;
+  ls.load(filename);
+  EXPECT_EQ(hd.total_weight(), md.total_weight());
+  EXPECT_EQ(hd.total_weight(), ls.total_weight());
+  ASSERT_EQ(hd.weight().size(), md.weight().size());
+  ASSERT_EQ(hd.weight().size(), ms.weight().size());
+  for (size_t i = 0; i < hd.weight().size(); ++i) {
+    EXPECT_EQ(hd.weight()[i], md.weight()[i]);
+    EXPECT_EQ(hd.weight()[i], ms.weight()[i]);
+    EXPECT_EQ(hd.weight()[i], ls.weight()[i]);
+  }
+
+  const auto hy = hd.marginalize(std::array<size_t, 2>{0, 2});
+  const auto my = ms.marginalize(std::array<size_t, 2>{0, 2});
+  ASSERT_EQ(hy.weight().size(), my.weight().size());
+  for (size_t i = 0; i < hy.weight().size(); ++i) {
+    EXPECT_EQ(hy.weight()[i], my.weight()[i]);
+  }
+  EXPECT_EQ(1, md.axis("y"));
+}
+
+TEST(decaying_histogram, decay) {
+  yuc::decaying_histogram h(10.);
+  h.rebin(0., 10., 10);
+  h.fill(1.5, 2.);
+  h.advance(10.);
+  EXPECT_DOUBLE_EQ(2. * std::exp(-1.), h.weight(1));
+  h.fill(7.5, 2. * std::exp(-1.));
+  EXPECT_DOUBLE_EQ(4. * std::exp(-1.), h.total_weight());
+  EXPECT_DOUBLE_EQ(4.5, h.mean());
+  EXPECT_DOUBLE_EQ(0.5, h.probability(7));
+  EXPECT_DOUBLE_EQ(2., h.quantile(0.5));
+
+  h.advance(10. + 700.); // renormalized, old samples vanish
+  h.fill(std::valarray<double>{3.5, 3.5, 4.5});
+  EXPECT_DOUBLE_EQ(3., h.total_weight());
+  EXPECT_DOUBLE_EQ(2., h.weight(3));
+  EXPECT_DOUBLE_EQ(11.5 / 3, h.mean());
+  h.advance(720.);
+  EXPECT_DOUBLE_EQ(3. * std::exp(-1.), h.decayed().total_weight());
+  EXPECT_DOUBLE_EQ(2. * std::exp(-1.), h.decayed().weight(3));
+  EXPECT_THROW(h.advance(0.), std::logic_error);
+}
@@ -0,0 +1,160 @@
+#include "loginterp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+static void expect_same(const yuc::log_interpolator &li,
+                        const std::vector<double> &xs) {
+  const auto ci = li.compile();
+  const auto ys = ci(xs);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    const double y = li(xs[i]);
+    if (std::isnan(y)) {
+      EXPECT_TRUE(std::isnan(ci(xs[i]))) << xs[i];
+      EXPECT_TRUE(std::isnan(ys[i])) << xs[i];
+    } else {
+      EXPECT_NEAR(y, ci(xs[i]), 1e-10 * y) << xs[i];
+      EXPECT_NEAR(y, ys[i], 1e-10 * y) << xs[i];
+    }
+  }
+}
+
+TEST(loginterp, compiled) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> u(-2, 5);
+  std::vector<double> xs = {-1, 0, 1e-3, 1, 1e5, 1e6};
+  for (int i = 0; i < 2000; ++i) {
+    xs.push_back(std::pow(10, u(gen)));
+  }
+
+  // log-uniform grid
+  yuc::log_interpolator uni;
+  for (int i = 0; i <= 40; ++i) {
+    const double x = std::pow(10., i / 10.);
+    uni.insert(x, 3 * x * x + x);
+  }
+  EXPECT_TRUE(uni.compile().uniform());
+  expect_same(uni, xs);
+
+  // irregular grid with zeros
+  yuc::log_interpolator irr;
+  for (double x : {0.5, 0.7, 2., 3., 10., 11., 50., 300., 1000., 2e4}) {
+    irr.insert(x, x > 5 && x < 100 ? 0 : std::sqrt(x));
+  }
+  EXPECT_FALSE(irr.compile().uniform());
+  expect_same(irr, xs);
+
+  // empty batches
+  const std::vector<double> none;
+  std::vector<double> out;
+  irr.compile()(none, out);
+  EXPECT_TRUE(irr.compile()(none).empty());
+
+  yuc::log_interpolator one;
+  one.insert(1., 1.);
+  EXPECT_TRUE(std::isnan(one.compile()(1.)));
+}
+
+TEST(loginterp, cursor) {
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> u(-1, 4);
+  yuc::log_interpolator li;
+  for (int i = 0; i < 300; ++i) {
+    const double x = std::pow(10, u(gen));
+    li.insert(x, x / (1 + x));
+  }
+  const auto ci = li.compile();
+  ASSERT_FALSE(ci.uniform());
+
+  // ascending, descending and random sweeps
+  auto cur = ci.make_cursor();
+  for (double lx = -2; lx < 5; lx += 1e-3) {
+    const double x = std::pow(10, lx);
+    ASSERT_EQ(ci(x), cur(x)) << x;
+  }
+  for (double lx = 5; lx > -2; lx -= 7e-3) {
+    const double x = std::pow(10, lx);
+    ASSERT_EQ(ci(x), cur(x)) << x;
+  }
+  size_t hint = 0;
+  for (int i = 0; i < 1000; ++i) {
+    const double x = std::pow(10, u(gen) * 1.2);
+    ASSERT_EQ(ci(x), ci(x, hint)) << x;
+  }
+  hint = 12345;
+  EXPECT_EQ(ci(1.), ci(1., hint));
+  EXPECT_TRUE(std::isnan(ci(-1., hint)));
+}
+
+TEST(loginterp, steffen) {
+  // exact on power laws, like the linear mode
+  yuc::log_interpolator pl;
+  for (double x : {0.1, 0.3, 1., 2., 7., 40.}) {
+    pl.insert(x, 2 * std::pow(x, -1.5));
+  }
+  const auto cs = pl.compile(yuc::log_interp::steffen);
+  for (double x : {0.01, 0.2, 1.5, 10., 100.}) {
+    EXPECT_NEAR(2 * std::pow(x, -1.5), cs(x), 1e-12 * cs(x)) << x;
+  }
+
+  // smooth and monotone on a curved table, without overshoot
+  yuc::log_interpolator li;
+  for (int i = 0; i <= 12; ++i) {
+    const double x = std::pow(10., i / 4.);
+    li.insert(x, 1 / (1 + x * x));
+  }
+  li.insert(1e4, 1e-8); // a plateau
+  li.insert(2e4, 1e-8);
+  const auto lin = li.compile(), cub = li.compile(yuc::log_interp::steffen);
+  double prev = cub(1.);
+  for (double lx = 0.01; lx < 3; lx += 0.01) {
+    const double x = std::pow(10., lx), y = cub(x);
+    EXPECT_LE(y, prev * (1 + 1e-12)) << x;
+    EXPECT_NEAR(1 / (1 + x * x), y, 0.02 * y) << x;
+    prev = y;
+  }
+  for (double x : {1e4, 1.2e4, 1.9e4, 2e4}) { // flat, no overshoot
+    EXPECT_NEAR(1e-8, cub(x), 1e-20) << x;
+  }
+  EXPECT_DOUBLE_EQ(lin(10.), cub(10.)); // at a point
+
+  std::vector<double> xs;
+  for (double lx = -1; lx < 5; lx += 0.013) {
+    xs.push_back(std::pow(10., lx));
+  }
+  const auto ys = cub(xs);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    EXPECT_NEAR(cub(xs[i]), ys[i], 1e-12 * ys[i]);
+  }
+}
+
+TEST(loginterp, bilinear_2d) {
+  // y = 3 x^2 z^-1 is reproduced exactly, also outside the grid
+  const std::vector<double> xs = {1, 2, 5, 10}, zs = {0.1, 1, 3};
+  std::vector<double> ys;
+  for (double x : xs) {
+    for (double z : zs) {
+      ys.push_back(3 * x * x / z);
+    }
+  }
+  yuc::log_interpolator_2d li(xs, zs, ys);
+  for (double x : {0.5, 1.5, 4., 10., 30.}) {
+    for (double z : {0.05, 0.2, 2., 5.}) {
+      EXPECT_NEAR(3 * x * x / z, li(x, z), 1e-12 * li(x, z)) << x << "," << z;
+    }
+  }
+  EXPECT_TRUE(std::isnan(li(-1, 1)));
+
+  // zero corners fall back to bilinear in y
+  ys[0] = 0;
+  yuc::log_interpolator_2d lz(xs, zs, ys);
+  EXPECT_EQ(0, lz(1, 0.1));
+  EXPECT_NEAR(0.5 * ys[1], lz(1, std::sqrt(0.1)), 1e-12);
+  EXPECT_NEAR(li(3, 2), lz(3, 2), 1e-12);
+
+  ys.pop_back();
+  EXPECT_THROW(yuc::log_interpolator_2d(xs, zs, ys), std::logic_error);
+  ys.push_back(1);
+  EXPECT_THROW(yuc::log_interpolator_2d(xs, std::vector<double>{1, 1, 2}, ys),
+               std::logic_error);
+}
@@ -0,0 +1,114 @@
+#include "text_parser"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+
+// reference: line by line with as_fields
+static std::vector<std::vector<double>> by_line(const std::string& filename,
+                                                size_t n) {
+  yuc::text_parser tp(filename, {"#", "//"});
+  std::vector<std::vector<double>> table;
+  for (tp.next_line(); !tp.fail(); tp.next_line()) {
+    auto fields = tp.as_fields<double>();
+    if (fields.empty()) {
+      continue;
+    }
+    if (table.empty()) {
+      table.resize(n ? n : fields.size());
+    }
+    for (size_t i = 0; i < table.size(); ++i) {
+      table[i].push_back(fields[i]);
+    }
+  }
+  return table;
+}
+
+TEST(text_parser, parse_columns) {
+  std::string filename = "test-text_parser-columns.txt";
+  {
+    std::ofstream f(filename);
+    f.precision(12);
+    f << "# x y z\n  time  value  error \n\n";
+    for (int i = 0; i < 100000; ++i) {
+      f << "  " << i * 0.125 << "\t" << -i << " +" << 1.5e-300 * i;
+      f << (i % 7 ? " // note\r\n" : "\n");
+      if (i % 1000 == 0) {
+        f << "# comment 1 2 3\n   \n";
+      }
+    }
+    f << "1 2 3";
+  }
+  for (size_t n : {0, 2, 3})
+  for (size_t nthread : {1, 0, 3}) {
+    yuc::text_parser tp(filename, {"#", "//"});
+    if (n) {
+      // past the header, which has no numbers
+      tp.next_line().next_line();
+    }
+    auto table = tp.parse_columns(n, nthread);
+    EXPECT_EQ(by_line(filename, n), table);
+    ASSERT_EQ(n ? n : 3, table.size());
+    ASSERT_EQ(100001u, table[0].size());
+    EXPECT_EQ(99999 * 0.125, table[0][99999]);
+    EXPECT_EQ(table.size(), table.back().back());
+    EXPECT_FALSE(tp.good());
+  }
+}
+
+TEST(text_parser, parse_columns_stop) {
+  std::string filename = "test-text_parser-stop.txt";
+  {
+    std::ofstream f(filename);
+    f << "\n1 2\n3 4 5\n\n6 7\n8\n";
+  }
+  yuc::text_parser tp(filename);
+  // a line without numbers ends the table unless skipped
+  tp.skip_empty_line = false;
+  EXPECT_TRUE(tp.parse_columns().empty());
+  EXPECT_EQ(1u, tp.current_lnum());
+  EXPECT_TRUE(tp.good());
+
+  // a short line is an error
+  tp.skip_empty_line = true;
+  try {
+    tp.parse_columns();
+    FAIL();
+  } catch (const std::runtime_error& e) {
+    EXPECT_EQ(filename + ":6: cannot read field 2 of 2", e.what());
+  }
+}
+
+TEST(text_parser, parse_columns_parallel) {
+  std::string filename = "test-text_parser-parallel.txt";
+  {
+    std::ofstream f(filename);
+    f << "\n\n";
+    for (int i = 0; i < 400000; ++i) {
+      f << i << " " << -i << (i % 3 ? "\n" : "\n\n");
+    }
+  }
+  yuc::text_parser tp(filename);
+  tp.skip_empty_line = false;
+  EXPECT_TRUE(tp.parse_columns(0, 4).empty());
+  EXPECT_EQ(1u, tp.current_lnum());
+  EXPECT_TRUE(tp.good());
+  tp.skip_empty_line = true;
+  auto table = tp.parse_columns(0, 4);
+  EXPECT_EQ(400000u, table[1].size());
+  EXPECT_EQ(-399999, table[1].back());
+  EXPECT_EQ(table[1].size(), table[1].capacity());
+  EXPECT_EQ(2 + 400000 + 133334u, tp.current_lnum());
+
+  {
+    std::ofstream f(filename, std::ios::app);
+    f << "1 2\n3\n4 5\n";
+  }
+  yuc::text_parser tp2(filename);
+  try {
+    tp2.parse_columns(0, 4);
+    FAIL();
+  } catch (const std::runtime_error& e) {
+    EXPECT_EQ(filename + ":533338: cannot read field 2 of 2", e.what());
+  }
+}
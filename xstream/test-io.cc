@@ -1,4 +1,5 @@
 #include "xstream"
+#include <cmath>
 #include <gtest/gtest.h>
 #include <string>
 
@@ -38,3 +39,284 @@ TEST(xstream, IO) {
     EXPECT_EQ(ovint[i], ivint[i]);
   }
 }
+
+TEST(xstream, bulk) {
+  std::string xfilename = "test-xstream-bulk.xdat";
+
+  std::valarray<double> ova(1 << 20);
+  std::vector<size_t> ovs(12345);
+  for (size_t i = 0; i < ova.size(); ++i) {
+    ova[i] = i * 0.25 - 7;
+  }
+  for (size_t i = 0; i < ovs.size(); ++i) {
+    ovs[i] = i * i;
+  }
+  yuc::oxstream(xfilename) << "head" << ova << std::vector<long>() << ovs
+                           << 3.5;
+
+  std::string head;
+  std::valarray<double> iva;
+  std::vector<long> ive = {1};
+  std::vector<size_t> ivs;
+  double tail;
+  yuc::ixstream ix(xfilename);
+  ix >> head >> iva >> ive >> ivs >> tail;
+  EXPECT_TRUE(ix.good());
+  EXPECT_EQ("head", head);
+  EXPECT_TRUE((ova == iva).min());
+  EXPECT_TRUE(ive.empty());
+  EXPECT_EQ(ovs, ivs);
+  EXPECT_EQ(3.5, tail);
+
+  std::ifstream raw(xfilename, std::ios::binary | std::ios::ate);
+  EXPECT_EQ(8 * (1 + 1 + ova.size() + 1 + 1 + ovs.size() + 1),
+            size_t(raw.tellg()));
+}
+
+TEST(xstream, mapped) {
+  std::string xfilename = "test-xstream-mapped.xdat";
+  std::vector<std::string> ostr = {"", "1234567", "12345678", "label"};
+  std::valarray<double> oval = {1.5, -2, 1e300};
+  std::vector<std::vector<long>> onest = {{1, 2}, {}, {-3}};
+  yuc::oxstream(xfilename) << ostr << oval << onest << size_t(42);
+
+  yuc::xview<double> view;
+  {
+    yuc::mxstream mx(xfilename);
+    ASSERT_TRUE(mx.is_open());
+    std::vector<std::string> istr;
+    std::vector<std::vector<long>> inest;
+    size_t tail = 0;
+    mx >> istr >> view >> inest >> tail;
+    EXPECT_TRUE(mx.good());
+    EXPECT_EQ(ostr, istr);
+    EXPECT_EQ(onest, inest);
+    EXPECT_EQ(42u, tail);
+
+    // strings in place, and the same array copied
+    std::string_view sv;
+    std::valarray<double> ival;
+    mx.seekg(8);
+    mx >> sv;
+    EXPECT_EQ("", sv);
+    mx >> sv >> sv >> sv >> ival;
+    EXPECT_EQ("label", sv);
+    EXPECT_TRUE((oval == ival).min());
+
+    size_t n;
+    mx >> inest >> n;
+    EXPECT_EQ(42u, n);
+    mx >> n;
+    EXPECT_TRUE(mx.fail());
+    EXPECT_TRUE(mx.eof());
+  }
+  // the view outlives the stream
+  ASSERT_EQ(oval.size(), view.size());
+  for (size_t i = 0; i < oval.size(); ++i) {
+    EXPECT_EQ(oval[i], view[i]);
+  }
+
+  yuc::mxstream missing("test-xstream-missing.xdat");
+  EXPECT_FALSE(missing.is_open());
+  EXPECT_TRUE(missing.fail());
+}
+
+struct labelled {
+  std::string label;
+  long id;
+  double value;
+  auto tie() { return std::tie(label, id, value); }
+};
+
+TEST(xstream, buffered) {
+  std::string xfilename = "test-xstream-buffered.xdat";
+  const std::vector<double> big(100000, 0.5);
+  {
+    // a small buffer exercises refills and direct writes
+    yuc::oxfile ox(xfilename, 64);
+    ASSERT_TRUE(ox.is_open());
+    for (long i = 0; i < 1000; ++i) {
+      ox << labelled{"label-" + std::to_string(i), i, i * 0.5};
+    }
+    ox << std::make_tuple(std::string(100, 'x'), size_t(7)) << big
+       << std::string(12345, 'y') << std::array<double, 2>{1, 2}
+       << std::pair<long, const char *>(-1, "12345678");
+    EXPECT_TRUE(ox.good());
+  }
+
+  // same format as oxstream
+  std::string first;
+  yuc::ixstream(xfilename) >> first;
+  EXPECT_EQ("label-0", first);
+
+  for (size_t buffer : {64ul, yuc::ixfile::default_buffer}) {
+    yuc::ixfile ix(xfilename, buffer);
+    labelled r;
+    for (long i = 0; i < 1000; ++i) {
+      ix >> r;
+      ASSERT_EQ("label-" + std::to_string(i), r.label);
+      ASSERT_EQ(i, r.id);
+      ASSERT_EQ(i * 0.5, r.value);
+    }
+    std::tuple<std::string, size_t> t;
+    std::vector<double> ibig;
+    std::string s;
+    std::array<double, 2> a;
+    std::pair<long, std::string> p;
+    ix >> t >> ibig >> s >> a >> p;
+    EXPECT_TRUE(ix.good());
+    EXPECT_EQ(std::string(100, 'x'), std::get<0>(t));
+    EXPECT_EQ(7u, std::get<1>(t));
+    EXPECT_EQ(big, ibig);
+    EXPECT_EQ(std::string(12345, 'y'), s);
+    EXPECT_EQ(2, a[1]);
+    EXPECT_EQ(-1, p.first);
+    EXPECT_EQ("12345678", p.second);
+    double d;
+    ix >> d;
+    EXPECT_TRUE(ix.fail());
+    EXPECT_TRUE(ix.eof());
+  }
+}
+
+TEST(xstream, compressed) {
+  std::string xfilename = "test-xstream-compressed.xdat";
+  std::vector<std::vector<double>> curves;
+  for (size_t k = 0; k < 20; ++k) {
+    std::vector<double> c(5000);
+    for (size_t i = 0; i < c.size(); ++i) {
+      c[i] = 1e3 + k + std::floor(i * 0.37) * 0.25;
+    }
+    curves.push_back(c);
+  }
+  for (size_t chunk : {100ul, 4096ul, yuc::oxzfile::default_chunk}) {
+    {
+      yuc::oxzfile ox(xfilename, chunk);
+      ASSERT_TRUE(ox.is_open());
+      ox << "curves";
+      for (const auto& c : curves) {
+        ox << c;
+      }
+      ox << labelled{"end", -1, 0.5};
+      EXPECT_EQ(22u, ox.values());
+      EXPECT_TRUE(ox.good());
+    }
+    if (chunk > 100) {
+      // smooth data shrinks
+      std::ifstream f(xfilename, std::ios::binary | std::ios::ate);
+      EXPECT_LT(size_t(f.tellg()) * 3, curves.size() * 5000 * 8);
+    }
+
+    yuc::ixzfile ix(xfilename);
+    ASSERT_TRUE(ix.good());
+    EXPECT_EQ(22u, ix.values());
+    std::string name;
+    ix >> name;
+    EXPECT_EQ("curves", name);
+    std::vector<double> c;
+    for (const auto& e : curves) {
+      ix >> c;
+      ASSERT_EQ(e, c);
+    }
+    labelled r;
+    ix >> r;
+    EXPECT_EQ("end", r.label);
+    double d;
+    ix >> d;
+    EXPECT_TRUE(ix.eof());
+
+    // random access
+    for (size_t i : {15ul, 3ul, 20ul, 1ul}) {
+      ix.seek(i) >> c;
+      ASSERT_TRUE(ix.good());
+      ASSERT_EQ(curves[i - 1], c);
+    }
+    ix.seek(21) >> r;
+    EXPECT_EQ(-1, r.id);
+    EXPECT_TRUE(ix.seek(22).fail());
+  }
+
+  // not a container
+  yuc::oxstream("test-xstream-plain.xdat") << curves;
+  EXPECT_TRUE(yuc::ixzfile("test-xstream-plain.xdat").fail());
+  yuc::ixzfile closed;
+  EXPECT_TRUE(closed.seek(0).fail());
+
+  // corrupted header and index
+  auto patch = [&](bool from_end, long offset, size_t v) {
+    std::fstream f(xfilename, std::ios::in | std::ios::out | std::ios::binary);
+    size_t at = offset;
+    if (from_end) {
+      f.seekg(-16, std::ios::end);
+      f.read(reinterpret_cast<char *>(&at), 8);
+      at += offset;
+    }
+    f.seekp(at);
+    f.write(reinterpret_cast<const char *>(&v), 8);
+  };
+  auto write = [&] {
+    yuc::oxzfile ox(xfilename, 4096);
+    for (const auto &c : curves) {
+      ox << c;
+    }
+  };
+  write(), patch(false, 8, 2); // version
+  EXPECT_TRUE(yuc::ixzfile(xfilename).fail());
+  write(), patch(true, 8 + 16, size_t(1) << 60); // raw size of chunk 0
+  EXPECT_TRUE(yuc::ixzfile(xfilename).fail());
+  write(), patch(true, 8 + 8, size_t(1) << 50); // stored size of chunk 0
+  EXPECT_TRUE(yuc::ixzfile(xfilename).fail());
+  write(), patch(true, 8, size_t(1) << 40); // offset of chunk 0
+  EXPECT_TRUE(yuc::ixzfile(xfilename).fail());
+  write();
+  EXPECT_TRUE(yuc::ixzfile(xfilename).good());
+}
+
+TEST(xstream, async) {
+  std::string xfilename = "test-xstream-async.xdat";
+  const std::vector<double> big(100000, 0.25);
+  for (bool direct : {false, true}) {
+    {
+      // a small buffer and 3 of them, so filling waits on the writer
+      yuc::aoxfile ox(xfilename, 4096, 3, direct);
+      ASSERT_TRUE(ox.is_open());
+      for (long i = 0; i < 1000; ++i) {
+        ox << labelled{"label-" + std::to_string(i), i, i * 0.5};
+      }
+      // an early flush leaves an unaligned tail
+      ox << "middle";
+      auto done = ox.sync();
+      done.wait();
+      std::string middle;
+      yuc::ixfile ix(xfilename);
+      labelled r;
+      for (long i = 0; i < 1000; ++i) {
+        ix >> r;
+      }
+      ix >> middle;
+      EXPECT_EQ("middle", middle);
+
+      ox << big << std::string(12345, 'y');
+      EXPECT_TRUE(ox.wait());
+      ox << "end";
+    }
+
+    yuc::ixfile ix(xfilename);
+    labelled r;
+    for (long i = 0; i < 1000; ++i) {
+      ix >> r;
+      ASSERT_EQ("label-" + std::to_string(i), r.label);
+      ASSERT_EQ(i * 0.5, r.value);
+    }
+    std::string s;
+    std::vector<double> ibig;
+    ix >> s >> ibig >> s;
+    EXPECT_EQ(big, ibig);
+    EXPECT_EQ(std::string(12345, 'y'), s);
+    ix >> s;
+    EXPECT_EQ("end", s);
+    double d;
+    ix >> d;
+    EXPECT_TRUE(ix.eof());
+  }
+}